@@ -84,16 +84,32 @@ class ImageInput {
             std::ifstream in("output.txt");
             if (!in) return;
 
+            sampleTargetColors(resized, readPositions(in));
+        }
+
+        // Reads up to PARTICLE_COUNT "x y" pairs, as written by World on exit.
+        std::vector<sf::Vector2f> readPositions(std::istream& in) const {
+            std::vector<sf::Vector2f> positions;
+            positions.reserve((std::size_t)PARTICLE_COUNT);
+
+            float x, y;
+            while (positions.size() < (std::size_t)PARTICLE_COUNT && (in >> x >> y)) {
+                positions.emplace_back(x, y);
+            }
+            return positions;
+        }
+
+        // Assigns each particle index the colour under its final position.
+        void sampleTargetColors(const sf::Image& resized, const std::vector<sf::Vector2f>& positions) {
             const int W = (int)resized.getSize().x;
             const int H = (int)resized.getSize().y;
 
             targetColors.clear();
-            targetColors.reserve((std::size_t)PARTICLE_COUNT);
+            targetColors.reserve(positions.size());
 
-            float x, y;
-            while (targetColors.size() < (std::size_t)PARTICLE_COUNT && (in >> x >> y)) {
-                int px = clampi((int)std::lround(x), 0, W - 1);
-                int py = clampi((int)std::lround(y), 0, H - 1);
+            for (const auto& pos : positions) {
+                int px = clampi((int)std::lround(pos.x), 0, W - 1);
+                int py = clampi((int)std::lround(pos.y), 0, H - 1);
                 targetColors.push_back(resized.getPixel((unsigned)px, (unsigned)py));
             }
 
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// How collision slices are handed out to the worker pool.
+//  Dynamic: workers grab the next slice from a shared atomic counter (load balancing)
+//  Static:  worker i always runs the i-th contiguous block of jobs (owner-computes, pairs with first-touch)
+enum class Schedule { Dynamic, Static };
+
+// Collision solver.
+//  GaussSeidel: pairs are resolved in place; even/odd column passes keep neighbouring slices apart
+//  Jacobi:      each particle gathers its corrections into a delta buffer in one pass, applied afterwards
+enum class Solver { GaussSeidel, Jacobi };
+
+// How SplatRenderer combines particles landing on the same pixel: mean colour, or saturating sum.
+enum class SplatBlend { Average, Additive };
+
+// Runtime options for the simulation: worker pool, solver and renderer.
+struct RunConfig {
+    int threadCount = 0;          // 0 = std::thread::hardware_concurrency()
+    std::vector<int> cpus;        // worker i is pinned to cpus[i % cpus.size()]; empty = no pinning
+    Schedule schedule = Schedule::Dynamic;
+    bool firstTouch = true;       // workers initialise the grid columns / particle pages they own
+    Solver solver = Solver::GaussSeidel;
+    SplatBlend splatBlend = SplatBlend::Average;
+
+    int resolvedThreadCount() const {
+        int n = threadCount > 0 ? threadCount : static_cast<int>(std::thread::hardware_concurrency());
+        return std::max(1, n);
+    }
+
+    // Parses lists such as "0-3,8,10-11".
+    static bool parseCpuList(const std::string& s, std::vector<int>& out) {
+        std::vector<int> cpus;
+        std::size_t pos = 0;
+
+        while (pos < s.size()) {
+            std::size_t comma = s.find(',', pos);
+            if (comma == std::string::npos) comma = s.size();
+            const std::string tok = s.substr(pos, comma - pos);
+            pos = comma + 1;
+            if (tok.empty()) continue;
+
+            char* end = nullptr;
+            const long lo = std::strtol(tok.c_str(), &end, 10);
+            long hi = lo;
+            if (*end == '-') hi = std::strtol(end + 1, &end, 10);
+            if (*end != '\0' || lo < 0 || hi < lo) return false;
+
+            for (long c = lo; c <= hi; ++c) cpus.push_back(static_cast<int>(c));
+        }
+
+        if (cpus.empty()) return false;
+        out = std::move(cpus);
+        return true;
+    }
+
+    // Environment (PSIM_THREADS, PSIM_AFFINITY, PSIM_SCHEDULE, PSIM_FIRST_TOUCH, PSIM_SOLVER,
+    // PSIM_SPLAT_BLEND) is read first, command line flags (--threads=N, --affinity=LIST,
+    // --schedule=static|dynamic, --no-first-touch, --solver=gauss-seidel|jacobi,
+    // --splat-blend=average|additive) override it.
+    static RunConfig fromEnvAndArgs(int argc, char** argv) {
+        RunConfig cfg;
+
+        if (const char* v = std::getenv("PSIM_THREADS"))     cfg.set("threads", v);
+        if (const char* v = std::getenv("PSIM_AFFINITY"))    cfg.set("affinity", v);
+        if (const char* v = std::getenv("PSIM_SCHEDULE"))    cfg.set("schedule", v);
+        if (const char* v = std::getenv("PSIM_FIRST_TOUCH")) cfg.set("first-touch", v);
+        if (const char* v = std::getenv("PSIM_SOLVER"))      cfg.set("solver", v);
+        if (const char* v = std::getenv("PSIM_SPLAT_BLEND")) cfg.set("splat-blend", v);
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) continue;
+
+            if (arg == "--no-first-touch") { cfg.firstTouch = false; continue; }
+
+            const std::size_t eq = arg.find('=');
+            if (eq == std::string::npos) continue;
+            cfg.set(arg.substr(2, eq - 2), arg.substr(eq + 1));
+        }
+
+        return cfg;
+    }
+
+    // Pins the calling thread according to its worker index. No-op when no cpu list is configured.
+    bool pinCurrentThread(int workerIdx) const {
+        if (cpus.empty()) return true;
+
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[workerIdx % cpus.size()], &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+#else
+        (void)workerIdx;
+        return false;
+#endif
+    }
+
+    std::string describe() const {
+        std::string s = std::to_string(resolvedThreadCount()) + " threads, ";
+        s += (schedule == Schedule::Static) ? "static" : "dynamic";
+        s += cpus.empty() ? ", unpinned" : ", pinned";
+        s += firstTouch ? ", first-touch" : ", main-touch";
+        s += (solver == Solver::Jacobi) ? ", jacobi" : ", gauss-seidel";
+        s += (splatBlend == SplatBlend::Additive) ? ", additive" : ", average";
+        return s;
+    }
+
+private:
+    void set(const std::string& key, const std::string& value) {
+        if (key == "threads") {
+            threadCount = std::max(0, std::atoi(value.c_str()));
+        } else if (key == "affinity") {
+            if (!parseCpuList(value, cpus)) {
+                std::cerr << "Ignoring invalid cpu list '" << value << "'\n";
+            }
+        } else if (key == "schedule") {
+            if (value == "static")       schedule = Schedule::Static;
+            else if (value == "dynamic") schedule = Schedule::Dynamic;
+            else std::cerr << "Unknown schedule '" << value << "'\n";
+        } else if (key == "solver") {
+            if (value == "jacobi")            solver = Solver::Jacobi;
+            else if (value == "gauss-seidel") solver = Solver::GaussSeidel;
+            else std::cerr << "Unknown solver '" << value << "'\n";
+        } else if (key == "splat-blend") {
+            if (value == "average")       splatBlend = SplatBlend::Average;
+            else if (value == "additive") splatBlend = SplatBlend::Additive;
+            else std::cerr << "Unknown splat blend '" << value << "'\n";
+        } else if (key == "first-touch") {
+            firstTouch = !(value == "0" || value == "off" || value == "false");
+        }
+    }
+};
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Particle.hpp"
+#include "RunConfig.hpp"
+
+// Rasterises particles straight into a CPU RGBA framebuffer and uploads it as one texture.
+// Particles are binned into horizontal bands of pixel rows (parallel over particle chunks),
+// then every band is stamped and resolved by a single job, so no two jobs write the same pixel.
+class SplatRenderer {
+    public:
+        using Job = std::function<void(std::size_t)>;
+        using ParallelFor = std::function<void(std::size_t, const Job&)>;
+
+    private:
+        static constexpr int BAND_HEIGHT = 16;
+        static constexpr std::size_t CHUNK_SIZE = 16384;
+
+        struct Accum {
+            std::uint32_t r, g, b, n;
+        };
+
+        sf::Texture texture;
+        sf::Sprite sprite;
+        unsigned width = 0;
+        unsigned height = 0;
+        int bandCount = 0;
+
+        std::vector<Accum> accum;
+        std::vector<std::uint8_t> pixels;
+        std::vector<std::uint32_t> chunkBands;   // [chunk * bandCount + band]: counts, then write offsets
+        std::vector<std::uint32_t> bandStart;    // bandCount + 1 offsets into binned
+        std::vector<std::uint32_t> binned;       // particle ids grouped by band
+
+        // World -> framebuffer pixel mapping, taken from the target's view.
+        float originX = 0.f, originY = 0.f;
+        float scaleX = 1.f, scaleY = 1.f;
+
+        void resize(unsigned w, unsigned h) {
+            if (w == width && h == height) return;
+
+            width = w;
+            height = h;
+            bandCount = static_cast<int>((h + BAND_HEIGHT - 1) / BAND_HEIGHT);
+
+            accum.assign(static_cast<std::size_t>(w) * h, Accum{});
+            pixels.assign(static_cast<std::size_t>(w) * h * 4, 0);
+            texture.create(w, h);
+            sprite.setTexture(texture, true);
+        }
+
+        // Bands touched by the particle's disc; false if it is entirely off-screen.
+        bool bandRange(const Particle &p, int &b0, int &b1) const {
+            const float px = (p.position.x - originX) * scaleX;
+            const float py = (p.position.y - originY) * scaleY;
+            const float r  = p.radius * scaleX;
+
+            if (px + r < 0.f || py + r < 0.f || px - r >= width || py - r >= height) return false;
+
+            const int y0 = std::max(0, static_cast<int>(py - r));
+            const int y1 = std::min(static_cast<int>(height) - 1, static_cast<int>(py + r));
+            b0 = y0 / BAND_HEIGHT;
+            b1 = y1 / BAND_HEIGHT;
+            return true;
+        }
+
+        void countChunk(std::size_t chunk, const std::vector<Particle> &particles) {
+            std::uint32_t* counts = &chunkBands[chunk * bandCount];
+            std::fill(counts, counts + bandCount, 0u);
+
+            const std::size_t end = std::min(particles.size(), (chunk + 1) * CHUNK_SIZE);
+            for (std::size_t i = chunk * CHUNK_SIZE; i < end; ++i) {
+                int b0, b1;
+                if (!bandRange(particles[i], b0, b1)) continue;
+                for (int b = b0; b <= b1; ++b) ++counts[b];
+            }
+        }
+
+        void scatterChunk(std::size_t chunk, const std::vector<Particle> &particles) {
+            std::uint32_t* offsets = &chunkBands[chunk * bandCount];
+
+            const std::size_t end = std::min(particles.size(), (chunk + 1) * CHUNK_SIZE);
+            for (std::size_t i = chunk * CHUNK_SIZE; i < end; ++i) {
+                int b0, b1;
+                if (!bandRange(particles[i], b0, b1)) continue;
+                for (int b = b0; b <= b1; ++b) binned[offsets[b]++] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        inline void add(Accum &a, const sf::Color &c) {
+            a.r += c.r;
+            a.g += c.g;
+            a.b += c.b;
+            a.n += 1;
+        }
+
+        void rasterBand(int band, const std::vector<Particle> &particles) {
+            const int rowBegin = band * BAND_HEIGHT;
+            const int rowEnd   = std::min(static_cast<int>(height), rowBegin + BAND_HEIGHT);
+            const int w = static_cast<int>(width);
+
+            Accum* rows = &accum[static_cast<std::size_t>(rowBegin) * w];
+            std::fill(rows, rows + static_cast<std::size_t>(rowEnd - rowBegin) * w, Accum{});
+
+            for (std::uint32_t k = bandStart[band]; k < bandStart[band + 1]; ++k) {
+                const Particle &p = particles[binned[k]];
+                const float px = (p.position.x - originX) * scaleX;
+                const float py = (p.position.y - originY) * scaleY;
+                const float r  = p.radius * scaleX;
+
+                // Sub-pixel particles: point splat.
+                if (r < 1.f) {
+                    const int x = static_cast<int>(px);
+                    const int y = static_cast<int>(py);
+                    if (x >= 0 && x < w && y >= rowBegin && y < rowEnd) {
+                        add(accum[static_cast<std::size_t>(y) * w + x], p.color);
+                    }
+                    continue;
+                }
+
+                // Disc stamp: pixels whose centre lies inside the radius.
+                const int x0 = std::max(0, static_cast<int>(std::floor(px - r)));
+                const int x1 = std::min(w - 1, static_cast<int>(std::ceil(px + r)));
+                const int y0 = std::max(rowBegin, static_cast<int>(std::floor(py - r)));
+                const int y1 = std::min(rowEnd - 1, static_cast<int>(std::ceil(py + r)));
+                const float r2 = r * r;
+
+                for (int y = y0; y <= y1; ++y) {
+                    const float dy = (y + 0.5f) - py;
+                    Accum* row = &accum[static_cast<std::size_t>(y) * w];
+                    for (int x = x0; x <= x1; ++x) {
+                        const float dx = (x + 0.5f) - px;
+                        if (dx * dx + dy * dy <= r2) add(row[x], p.color);
+                    }
+                }
+            }
+
+            resolveRows(rowBegin, rowEnd);
+        }
+
+        void resolveRows(int rowBegin, int rowEnd) {
+            const std::size_t begin = static_cast<std::size_t>(rowBegin) * width;
+            const std::size_t end   = static_cast<std::size_t>(rowEnd) * width;
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const Accum &a = accum[i];
+                std::uint8_t* out = &pixels[i * 4];
+
+                if (a.n == 0) {
+                    out[0] = out[1] = out[2] = out[3] = 0;
+                } else if (blend == SplatBlend::Average) {
+                    out[0] = static_cast<std::uint8_t>(a.r / a.n);
+                    out[1] = static_cast<std::uint8_t>(a.g / a.n);
+                    out[2] = static_cast<std::uint8_t>(a.b / a.n);
+                    out[3] = 255;
+                } else {
+                    out[0] = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, a.r));
+                    out[1] = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, a.g));
+                    out[2] = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, a.b));
+                    out[3] = 255;
+                }
+            }
+        }
+
+    public:
+        SplatBlend blend = SplatBlend::Average;
+
+        // Projected radius in pixels of a particle of world radius r under the target's current view.
+        static float projectedRadius(const sf::RenderTarget &target, float r) {
+            return r * static_cast<float>(target.getSize().x) / target.getView().getSize().x;
+        }
+
+        void build(const std::vector<Particle> &particles, const sf::RenderTarget &target, const ParallelFor &parallelFor) {
+            resize(target.getSize().x, target.getSize().y);
+
+            const sf::View &view = target.getView();
+            scaleX  = static_cast<float>(width)  / view.getSize().x;
+            scaleY  = static_cast<float>(height) / view.getSize().y;
+            originX = view.getCenter().x - view.getSize().x / 2.f;
+            originY = view.getCenter().y - view.getSize().y / 2.f;
+
+            const std::size_t chunkCount = std::max<std::size_t>(1, (particles.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+            chunkBands.resize(chunkCount * bandCount);
+
+            parallelFor(chunkCount, [this, &particles] (std::size_t c) {
+                countChunk(c, particles);
+            });
+
+            // Exclusive scan, band-major, turning per-chunk counts into write offsets.
+            bandStart.resize(bandCount + 1);
+            std::uint32_t running = 0;
+            for (int b = 0; b < bandCount; ++b) {
+                bandStart[b] = running;
+                for (std::size_t c = 0; c < chunkCount; ++c) {
+                    const std::uint32_t n = chunkBands[c * bandCount + b];
+                    chunkBands[c * bandCount + b] = running;
+                    running += n;
+                }
+            }
+            bandStart[bandCount] = running;
+            binned.resize(running);
+
+            parallelFor(chunkCount, [this, &particles] (std::size_t c) {
+                scatterChunk(c, particles);
+            });
+
+            parallelFor(static_cast<std::size_t>(bandCount), [this, &particles] (std::size_t b) {
+                rasterBand(static_cast<int>(b), particles);
+            });
+
+            texture.update(pixels.data());
+        }
+
+        // The framebuffer is already in window pixels, so it is drawn under the default view.
+        void draw(sf::RenderTarget &target) {
+            const sf::View view = target.getView();
+            target.setView(target.getDefaultView());
+            target.draw(sprite);
+            target.setView(view);
+        }
+};
@@ -6,23 +6,47 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <utility>
 
 #include <thread>
 #include <condition_variable>
 #include <mutex>
 #include <atomic>
+#include <functional>
 
 #include "ImageInput.hpp"
 #include "Config.hpp"
 #include "Particle.hpp"
 #include "ParticleRenderer.hpp"
+#include "SplatRenderer.hpp"
+#include "RunConfig.hpp"
 
 struct Slice {
     int start;
     int end;
 };
 
+// Leaves trivially constructible elements uninitialised on resize, so the pages of a
+// freshly allocated buffer are not touched until a worker writes to them.
+template <typename T>
+struct DefaultInitAllocator : std::allocator<T> {
+    template <typename U> struct rebind { using other = DefaultInitAllocator<U>; };
+
+    DefaultInitAllocator() = default;
+    template <typename U> DefaultInitAllocator(const DefaultInitAllocator<U>&) noexcept {}
+
+    template <typename U> void construct(U* p) noexcept { ::new (static_cast<void*>(p)) U; }
+    template <typename U, typename... Args> void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
 class World {
+    // Kernel microbenchmarks (bench/KernelBench.cpp) drive the private hot paths directly.
+    friend struct WorldBench;
+
 private:
     const bool savePos;
     const int PARTICLE_COUNT;
@@ -44,32 +68,117 @@ private:
 
     const float dt = 1.f / 60.f;
 
-    ParticleRenderer renderer = ParticleRenderer(PARTICLE_COUNT);
+    // Above this many particles, or once particles project to fewer pixels than this radius,
+    // the per-particle quads cost more than rasterising on the CPU.
+    static constexpr std::size_t SPLAT_PARTICLE_THRESHOLD = 200'000;
+    static constexpr float SPLAT_MAX_RADIUS_PX = 1.5f;
+
+    // Quads are only drawn below the splat threshold, so never need more vertices than that.
+    ParticleRenderer renderer = ParticleRenderer(std::min(PARTICLE_COUNT, static_cast<int>(SPLAT_PARTICLE_THRESHOLD)));
+    SplatRenderer splatRenderer;
 
     static constexpr int CELL_CAP = 10;
     struct Cell {
         std::uint8_t count;
         int ids[CELL_CAP];
     };
-    std::vector<Cell> grid;
+    std::vector<Cell, DefaultInitAllocator<Cell>> grid;
+
+    // Jacobi mode: per-particle position corrections, written only by the job owning the particle's cell.
+    // PARTICLE_COUNT raw elements, constructed per ownedChunk by the workers (see firstTouch).
+    struct FreeDeleter {
+        void operator()(void* p) const { std::free(p); }
+    };
+    std::unique_ptr<sf::Vector2f[], FreeDeleter> deltas;
+    static constexpr float JACOBI_RELAXATION = 0.8f;
+
+    const RunConfig runCfg;
+    const int threadCount;
+    static constexpr std::size_t TOUCH_STRIDE = 4096;
 
     std::mutex mtx;
     std::condition_variable cvDone, cvWork;
     std::vector<std::thread> workers;
     std::atomic<bool> stop{false};
     std::vector<Slice> evenSlices, oddSlices;
-    const std::vector<Slice>* currentSlices = nullptr;
+    std::vector<Slice> jacobiSlices;
+    const std::function<void(std::size_t)>* currentJob = nullptr;
+    std::size_t currentJobCount = 0;
     std::atomic<std::size_t> nextJob{0};
     std::atomic<int> remaining{0};
     uint64_t generation = 0;
 
     ImageInput imgInp = ImageInput(PARTICLE_COUNT);
 
-    void workerLoop() {
+    // Particle indices owned by worker id: an equal share of PARTICLE_COUNT, clipped to limit.
+    // The per-substep particle sweep runs job id over the same range, so under the static schedule
+    // each worker integrates exactly the particles whose pages it first-touched.
+    void ownedChunk(const int id, const std::size_t limit, std::size_t &begin, std::size_t &end) const {
+        const std::size_t chunk = (static_cast<std::size_t>(PARTICLE_COUNT) + threadCount - 1) / threadCount;
+        begin = std::min(limit, id * chunk);
+        end   = std::min(limit, begin + chunk);
+    }
+
+    // Jobs run by worker id under the static schedule: a contiguous block of the count jobs.
+    void ownedJobs(const int id, const std::size_t count, std::size_t &begin, std::size_t &end) const {
+        begin = id * count / threadCount;
+        end   = (id + 1) * count / threadCount;
+    }
+
+    // Each worker zeroes the grid columns of the slices it solves under the static schedule,
+    // constructs its chunk of the Jacobi deltas and touches one byte per page of its owned chunk
+    // of the reserved particle storage, so that on NUMA machines those pages are placed on the
+    // worker's node.
+    void firstTouch(const int id) {
+        std::vector<const std::vector<Slice>*> solved = { &evenSlices, &oddSlices };
+        if (runCfg.solver == Solver::Jacobi) solved = { &jacobiSlices };
+
+        for (const auto* slices : solved) {
+            std::size_t first, last;
+            ownedJobs(id, slices->size(), first, last);
+            for (std::size_t j = first; j < last; ++j) {
+                const Slice &s = (*slices)[j];
+                for (int i = s.start * GRID_ROWS; i < s.end * GRID_ROWS; ++i) {
+                    grid[i].count = 0;
+                }
+            }
+        }
+
+        // Particle pages are placed by writing single bytes into the vector's reserved but not yet
+        // constructed storage. That is raw memory from the allocator, so the byte writes create no
+        // Particle and the later emplace_back constructs over them. The placement only holds while
+        // that block stays the vector's storage: the constructor reserves PARTICLE_COUNT and
+        // spawnIfPossible never grows past it, so the vector never reallocates. It also only has an
+        // effect when the block comes back as fresh pages; large reserves on a new process are
+        // mmap'd, see bench/AffinityBench.cpp.
+        std::size_t begin, end;
+        ownedChunk(id, std::min(particles.capacity(), static_cast<std::size_t>(PARTICLE_COUNT)), begin, end);
+
+        volatile char* raw = reinterpret_cast<char*>(particles.data());
+        for (std::size_t off = begin * sizeof(Particle); off < end * sizeof(Particle); off += TOUCH_STRIDE) {
+            raw[off] = 0;
+        }
+
+        ownedChunk(id, static_cast<std::size_t>(PARTICLE_COUNT), begin, end);
+        std::uninitialized_fill(deltas.get() + begin, deltas.get() + end, sf::Vector2f(0.f, 0.f));
+    }
+
+    void workerLoop(const int id) {
+        if (!runCfg.pinCurrentThread(id)) {
+            std::cerr << "Failed to pin worker " << id << "\n";
+        }
+        if (runCfg.firstTouch) firstTouch(id);
+
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mtx);
+            cvDone.notify_one();
+        }
+
         uint64_t localGen = 0;
 
         while (true) {
-            const std::vector<Slice>* slicesPtr = nullptr;
+            const std::function<void(std::size_t)>* jobPtr = nullptr;
+            std::size_t jobCount = 0;
 
             {
                 std::unique_lock<std::mutex> lock(mtx);
@@ -80,13 +189,22 @@ private:
                 if (stop.load(std::memory_order_acquire)) return;
 
                 localGen = generation;
-                slicesPtr = currentSlices;
+                jobPtr = currentJob;
+                jobCount = currentJobCount;
             }
 
-            for (;;) {
-                size_t j = nextJob.fetch_add(1, std::memory_order_relaxed);
-                if (j >= slicesPtr->size()) break;
-                solveSlice((*slicesPtr)[j]);
+            if (runCfg.schedule == Schedule::Static) {
+                std::size_t first, last;
+                ownedJobs(id, jobCount, first, last);
+                for (std::size_t j = first; j < last; ++j) {
+                    (*jobPtr)(j);
+                }
+            } else {
+                for (;;) {
+                    size_t j = nextJob.fetch_add(1, std::memory_order_relaxed);
+                    if (j >= jobCount) break;
+                    (*jobPtr)(j);
+                }
             }
 
             if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
@@ -96,10 +214,12 @@ private:
         }
     }
 
-    void runPass(const std::vector<Slice> &slices) {
+    // Runs job(0..count-1) on the worker pool and blocks until all of them are done.
+    void runJobs(std::size_t count, const std::function<void(std::size_t)> &job) {
         {
             std::lock_guard<std::mutex> lock(mtx);
-            currentSlices = &slices;
+            currentJob = &job;
+            currentJobCount = count;
             nextJob.store(0, std::memory_order_relaxed);
             remaining.store(static_cast<int>(workers.size()), std::memory_order_relaxed);
             generation++;
@@ -113,6 +233,13 @@ private:
         });
     }
 
+    void runPass(const std::vector<Slice> &slices) {
+        const std::function<void(std::size_t)> job = [this, &slices] (std::size_t j) {
+            solveSlice(slices[j]);
+        };
+        runJobs(slices.size(), job);
+    }
+
     void buildSlices(int threadCount) {
         evenSlices.clear();
         oddSlices.clear();
@@ -136,6 +263,13 @@ private:
             if ((s & 1) == 0) evenSlices.push_back(sl);
             else              oddSlices.push_back(sl);
         }
+
+        // Jacobi cells are independent, so slices can be any width; a few per worker for balance.
+        jacobiSlices.clear();
+        const int jacobiCount = std::min(GRID_COLS, 4 * threadCount);
+        for (int s = 0; s < jacobiCount; ++s) {
+            jacobiSlices.push_back({ s * GRID_COLS / jacobiCount, (s + 1) * GRID_COLS / jacobiCount });
+        }
     }
 
     void clearGrid() {
@@ -225,6 +359,85 @@ private:
         }
     }
 
+    // Correction for a alone from its overlap with b: half of the penetration, as in resolveCollision.
+    inline sf::Vector2f collisionOffset(const int aIdx, const int bIdx) const {
+        const Particle& a = particles[aIdx];
+        const Particle& b = particles[bIdx];
+
+        sf::Vector2f v = a.position - b.position;
+        float dist2 = v.x * v.x + v.y * v.y;
+        float min_dist = a.radius + b.radius;
+
+        // Coincident pair: push apart in opposite directions, decided by index.
+        if (dist2 < 1e-12f) { v = {aIdx < bIdx ? 1.f : -1.f, 0.f}; dist2 = 1.f; }
+
+        float min2 = min_dist * min_dist;
+        if (dist2 >= min2) return {0.f, 0.f};
+
+        float dist = std::sqrt(dist2);
+
+        float delta = 0.5f * (min_dist - dist);
+        return (v / dist) * delta;
+    }
+
+    // Jacobi gather: reads positions only and writes the delta of each particle in the slice's cells.
+    void gatherSlice(const Slice &s) {
+        for (int x = s.start; x < s.end; ++x) {
+            const int base = x * GRID_ROWS;
+
+            for (int y = 0; y < GRID_ROWS; ++y) {
+                const Cell &c = grid[base + y];
+                if (c.count == 0) continue;
+
+                for (int i = 0; i < c.count; ++i) {
+                    const int aIdx = c.ids[i];
+                    sf::Vector2f d = {0.f, 0.f};
+
+                    for (int nx = x - 1; nx <= x + 1; ++nx) {
+                        for (int ny = y - 1; ny <= y + 1; ++ny) {
+                            if (!inBoundsCell(nx, ny)) continue;
+
+                            const Cell &ncell = grid[cellIndex(nx, ny)];
+                            for (int k = 0; k < ncell.count; ++k) {
+                                const int bIdx = ncell.ids[k];
+                                if (bIdx != aIdx) d += collisionOffset(aIdx, bIdx);
+                            }
+                        }
+                    }
+
+                    deltas[aIdx] = d * JACOBI_RELAXATION;
+                }
+            }
+        }
+    }
+
+    // End of a substep over worker id's owned particles: gravity, the Jacobi correction when
+    // applyDeltas is set, border bounce and integration. Gravity is added here rather than before
+    // the collision passes; nothing reads acceleration in between, so the sum is unchanged.
+    void sweepOwned(const int id, const float substep_dt, const float padding, const float dampening, const bool applyDeltas) {
+        std::size_t begin, end;
+        ownedChunk(id, particles.size(), begin, end);
+
+        for (std::size_t i = begin; i < end; ++i) {
+            Particle &p = particles[i];
+            p.accelerate(Particle::GRAVITY);
+
+            if (applyDeltas) {
+                p.position += deltas[i];
+                deltas[i] = {0.f, 0.f};
+            }
+
+            p.applyBorderBounce((float)SCREEN_WIDTH, (float)SCREEN_HEIGHT, padding, dampening);
+            p.integrate(substep_dt);
+
+            sf::Vector2f disp = p.getDisplacement();
+            float disp2 = disp.x * disp.x + disp.y * disp.y;
+            if (disp2 > 2.f * padding) {
+                p.prev_position = p.position;
+            }
+        }
+    }
+
     void updateStartingVel() {
         if (goingUp) {
             if (startingVel.x + 25.f < 500.f) startingVel.x += 25.f;
@@ -256,24 +469,40 @@ private:
 public:
     std::vector<Particle> particles;
 
-    World(const int count, const int substeps, const bool savePos)
+    World(const int count, const int substeps, const bool savePos, const RunConfig& config = {})
         : savePos(savePos)
         , PARTICLE_COUNT(count)
         , SUBSTEPS(substeps)
+        , runCfg(config)
+        , threadCount(config.resolvedThreadCount())
     {
         particles.reserve(count);
         grid.resize(GRID_ROWS * GRID_COLS);
+        // Raw storage: the elements are constructed by the workers that own them, or here without first-touch.
+        deltas.reset(static_cast<sf::Vector2f*>(std::malloc(std::max(1, PARTICLE_COUNT) * sizeof(sf::Vector2f))));
+        if (!runCfg.firstTouch) {
+            clearGrid();
+            std::uninitialized_fill_n(deltas.get(), PARTICLE_COUNT, sf::Vector2f(0.f, 0.f));
+        }
 
         imgInp.initTargetColorsIfAvailable();
+        splatRenderer.blend = runCfg.splatBlend;
 
-        int threadCount = static_cast<int>(std::thread::hardware_concurrency());
         buildSlices(threadCount);
+
+        // Workers pin themselves and first-touch their memory before entering the loop.
+        remaining.store(threadCount, std::memory_order_relaxed);
         workers.reserve(threadCount);
         for (int i = 0; i < threadCount; ++i) {
-            workers.emplace_back([this] () {
-                workerLoop();
+            workers.emplace_back([this, i] () {
+                workerLoop(i);
             });
         }
+
+        std::unique_lock<std::mutex> lock(mtx);
+        cvDone.wait(lock, [this] () {
+            return remaining.load(std::memory_order_relaxed) == 0;
+        });
     }
 
     ~World() {
@@ -343,6 +572,15 @@ public:
 
         buildGrid();
 
+        const bool jacobi = runCfg.solver == Solver::Jacobi;
+
+        const std::function<void(std::size_t)> gatherJob = [this] (std::size_t j) {
+            gatherSlice(jacobiSlices[j]);
+        };
+        const std::function<void(std::size_t)> sweepJob = [&, this] (std::size_t j) {
+            sweepOwned(static_cast<int>(j), substep_dt, padding, dampening, jacobi);
+        };
+
         for (int s = 0; s < SUBSTEPS; ++s) {
             int mx = 0, my = 0, rCells = 0;
             if (inpState.mouseHeld) {
@@ -351,10 +589,6 @@ public:
                 rCells = static_cast<int>(MOUSE_RADIUS / CELL_SIZE) + 1;
             }
 
-            for (auto &p : particles) {
-                p.accelerate(Particle::GRAVITY);
-            }
-
             if (inpState.mouseHeld) {
                 int x0 = std::max(0, mx - rCells);
                 int x1 = std::min(GRID_COLS - 1, mx + rCells);
@@ -371,28 +605,31 @@ public:
                 }
             }
 
-            runPass(evenSlices);
-            runPass(oddSlices);
-
-            for (auto& p : particles) {
-                p.applyBorderBounce((float)SCREEN_WIDTH, (float)SCREEN_HEIGHT, padding, dampening);
+            if (jacobi) {
+                runJobs(jacobiSlices.size(), gatherJob);
+            } else {
+                runPass(evenSlices);
+                runPass(oddSlices);
             }
 
-            for (auto& p : particles) {
-                p.integrate(substep_dt);
-
-                sf::Vector2f disp = p.getDisplacement();
-                float disp2 = disp.x * disp.x + disp.y * disp.y;
-                if (disp2 > 2.f * padding) {
-                    p.prev_position = p.position;
-                }
-            }
+            runJobs(static_cast<std::size_t>(threadCount), sweepJob);
 
             buildGrid();
         }
     }
 
     void draw(sf::RenderWindow& window) {
+        const bool splat = particles.size() >= SPLAT_PARTICLE_THRESHOLD ||
+            (!particles.empty() && SplatRenderer::projectedRadius(window, particles.front().radius) < SPLAT_MAX_RADIUS_PX);
+
+        if (splat) {
+            splatRenderer.build(particles, window, [this] (std::size_t n, const SplatRenderer::Job& job) {
+                runJobs(n, job);
+            });
+            splatRenderer.draw(window);
+            return;
+        }
+
         renderer.build(particles);
         renderer.draw(window);
     }
@@ -0,0 +1,101 @@
+// Compares worker pool policies (schedule x pinning x first-touch) on a settled pile.
+//
+//   ./particle-sim-affinity-bench [--particles=N] [--frames=N] [--threads=N] [--affinity=LIST]
+//
+// --affinity defaults to 0..threads-1 for the pinned variants.
+//
+// Every case runs in its own forked process. Within one process, once the first World is freed
+// glibc raises its mmap threshold and later reserves get the same, already resident, heap block
+// back, so first-touch and pinning would no longer decide where the pages live.
+
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <functional>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Bench.hpp"
+#include "Config.hpp"
+#include "Distributions.hpp"
+#include "Particle.hpp"
+#include "RunConfig.hpp"
+#include "World.hpp"
+
+namespace {
+
+double runCase(const RunConfig& cfg, int particleCount, int frames) {
+    World world(particleCount, 8, false, cfg);
+    fillParticles(world.particles, particleCount, Distribution::Piled);
+
+    return bench::timeFrames(world, 30, frames);
+}
+
+// Runs fn in a child process and returns its result, or -1 if the child failed.
+double runIsolated(const std::function<double()>& fn) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1.0;
+
+    std::fflush(stdout);
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1.0;
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        const double result = fn();
+        const bool ok = write(fds[1], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+        _exit(ok ? 0 : 1);
+    }
+
+    close(fds[1]);
+    double result = -1.0;
+    if (read(fds[0], &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result))) result = -1.0;
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? result : -1.0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const RunConfig base = RunConfig::fromEnvAndArgs(argc, argv);
+    const int particleCount = bench::intArg(argc, argv, "particles", 40'000);
+    const int frames        = bench::intArg(argc, argv, "frames", 200);
+
+    std::vector<int> pinned = base.cpus;
+    if (pinned.empty()) {
+        for (int c = 0; c < base.resolvedThreadCount(); ++c) pinned.push_back(c);
+    }
+
+    Particle::GRAVITY = {0.f, 100.f};
+
+    std::printf("%d particles, %d frames\n", particleCount, frames);
+    if (particleCount > pileCapacity()) {
+        std::printf("note: %d particles exceed the %d that fit a resting pile; the pile starts compressed\n",
+                    particleCount, pileCapacity());
+    }
+    std::printf("%-72s %12s\n", "policy", "ms/frame");
+
+    for (Schedule schedule : { Schedule::Dynamic, Schedule::Static }) {
+        for (bool pin : { false, true }) {
+            for (bool touch : { false, true }) {
+                RunConfig cfg = base;
+                cfg.schedule   = schedule;
+                cfg.cpus       = pin ? pinned : std::vector<int>{};
+                cfg.firstTouch = touch;
+
+                const double ms = runIsolated([&] () { return runCase(cfg, particleCount, frames); });
+                std::printf("%-72s %12.3f\n", cfg.describe().c_str(), ms);
+            }
+        }
+    }
+}
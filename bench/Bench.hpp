@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Config.hpp"
+#include "World.hpp"
+
+// Minimal microbenchmark harness: untimed setup before every call, fixed warmup and
+// repetition counts, per-repetition samples summarised as min/median/mean/stddev.
+
+namespace bench {
+
+inline std::string stringArg(int argc, char** argv, const std::string& name, const std::string& fallback) {
+    const std::string prefix = "--" + name + "=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind(prefix, 0) == 0) return arg.substr(prefix.size());
+    }
+    return fallback;
+}
+
+inline int intArg(int argc, char** argv, const std::string& name, int fallback) {
+    const std::string v = stringArg(argc, argv, name, "");
+    return v.empty() ? fallback : std::atoi(v.c_str());
+}
+
+// "1000,50000" -> {1000, 50000}
+inline std::vector<int> intListArg(int argc, char** argv, const std::string& name, const std::vector<int>& fallback) {
+    const std::string v = stringArg(argc, argv, name, "");
+    if (v.empty()) return fallback;
+
+    std::vector<int> out;
+    std::size_t pos = 0;
+    while (pos < v.size()) {
+        std::size_t comma = v.find(',', pos);
+        if (comma == std::string::npos) comma = v.size();
+        const int n = std::atoi(v.substr(pos, comma - pos).c_str());
+        if (n > 0) out.push_back(n);
+        pos = comma + 1;
+    }
+    return out.empty() ? fallback : out;
+}
+
+// Whole-frame timing: settle untimed frames, then the mean wall time of frames more, in ms.
+inline double timeFrames(World& world, int settle, int frames) {
+    InputState input;
+    for (int f = 0; f < settle; ++f) world.update(input);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) world.update(input);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / std::max(1, frames);
+}
+
+struct Case {
+    std::string name;
+    std::string distribution = "-";
+    int particles = 0;
+    int threads = 1;
+    long items = 0;       // work items per call, used for ns/item
+};
+
+struct Result {
+    Case c;
+    std::vector<double> samplesNs;
+    double minNs = 0, medianNs = 0, meanNs = 0, stddevNs = 0;
+};
+
+class Runner {
+private:
+    int warmup;
+    int reps;
+    std::string filter;
+    std::vector<Result> results;
+
+    static void summarise(Result& r) {
+        std::vector<double> s = r.samplesNs;
+        std::sort(s.begin(), s.end());
+
+        const std::size_t n = s.size();
+        r.minNs    = s.front();
+        r.medianNs = (n % 2) ? s[n / 2] : 0.5 * (s[n / 2 - 1] + s[n / 2]);
+        r.meanNs   = std::accumulate(s.begin(), s.end(), 0.0) / n;
+
+        double var = 0;
+        for (double x : s) var += (x - r.meanNs) * (x - r.meanNs);
+        r.stddevNs = (n > 1) ? std::sqrt(var / (n - 1)) : 0.0;
+    }
+
+public:
+    Runner(int warmup, int reps, std::string filter)
+        : warmup(std::max(0, warmup))
+        , reps(std::max(1, reps))
+        , filter(std::move(filter))
+    {}
+
+    bool enabled(const std::string& name) const {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    }
+
+    template <typename Setup, typename Body>
+    void run(const Case& c, Setup&& setup, Body&& body) {
+        if (!enabled(c.name)) return;
+
+        for (int i = 0; i < warmup; ++i) {
+            setup();
+            body();
+        }
+
+        Result r;
+        r.c = c;
+        r.samplesNs.reserve(reps);
+        for (int i = 0; i < reps; ++i) {
+            setup();
+            const auto t0 = std::chrono::steady_clock::now();
+            body();
+            const auto t1 = std::chrono::steady_clock::now();
+            r.samplesNs.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+        summarise(r);
+
+        const double perItem = c.items > 0 ? r.medianNs / c.items : 0.0;
+        std::printf("%-24s %-7s %9d %3d  median %12.0f ns  min %12.0f ns  sd %5.1f%%  %8.2f ns/item\n",
+                    c.name.c_str(), c.distribution.c_str(), c.particles, c.threads,
+                    r.medianNs, r.minNs, 100.0 * r.stddevNs / std::max(r.meanNs, 1.0), perItem);
+        std::fflush(stdout);
+
+        results.push_back(std::move(r));
+    }
+
+    bool writeJson(const std::string& path, const std::string& label) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out.precision(12);
+
+        out << "{\n  \"label\": \"" << label << "\",\n"
+            << "  \"warmup\": " << warmup << ",\n"
+            << "  \"reps\": " << reps << ",\n"
+            << "  \"results\": [\n";
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "    {\"name\": \"" << r.c.name << "\""
+                << ", \"distribution\": \"" << r.c.distribution << "\""
+                << ", \"particles\": " << r.c.particles
+                << ", \"threads\": " << r.c.threads
+                << ", \"items\": " << r.c.items
+                << ", \"min_ns\": " << r.minNs
+                << ", \"median_ns\": " << r.medianNs
+                << ", \"mean_ns\": " << r.meanNs
+                << ", \"stddev_ns\": " << r.stddevNs
+                << ", \"samples_ns\": [";
+            for (std::size_t k = 0; k < r.samplesNs.size(); ++k) {
+                out << (k ? ", " : "") << r.samplesNs[k];
+            }
+            out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        out << "  ]\n}\n";
+        return true;
+    }
+};
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+#include "Particle.hpp"
+
+// Synthetic, seeded particle layouts shared by the benchmarks. Every layout keeps all particles
+// on screen; see pileCapacity() for when Piled stops being a resting pile.
+enum class Distribution { Sparse, Dense, Piled };
+
+inline constexpr float LAYOUT_RADIUS = 2.f;
+inline constexpr float LAYOUT_MARGIN = 8.f;
+
+// Particles a touching (spacing = 2r) pile can hold on screen: about 49k at r = 2 on 896x896.
+// Beyond that the Piled rows are compressed to fit, so neighbours start out overlapping.
+inline int pileCapacity() {
+    const float spacing = 2.f * LAYOUT_RADIUS;
+    const int perRow = static_cast<int>((SCREEN_WIDTH  - 2.f * LAYOUT_MARGIN) / spacing);
+    const int rows   = static_cast<int>((SCREEN_HEIGHT - 2.f * LAYOUT_MARGIN) / spacing);
+    return perRow * rows;
+}
+
+inline const char* distributionName(Distribution d) {
+    switch (d) {
+        case Distribution::Sparse: return "sparse";
+        case Distribution::Dense:  return "dense";
+        case Distribution::Piled:  return "piled";
+    }
+    return "?";
+}
+
+inline void fillParticles(std::vector<Particle>& particles, int count, Distribution d, unsigned seed = 1) {
+    const float r = LAYOUT_RADIUS;
+    const float margin = LAYOUT_MARGIN;
+    std::mt19937 rng(seed);
+
+    particles.clear();
+    particles.reserve(count);
+
+    switch (d) {
+        case Distribution::Sparse: {
+            // Uniform over the whole screen.
+            std::uniform_real_distribution<float> ux(margin, SCREEN_WIDTH - margin);
+            std::uniform_real_distribution<float> uy(margin, SCREEN_HEIGHT - margin);
+            for (int i = 0; i < count; ++i) {
+                particles.emplace_back(sf::Vector2f(ux(rng), uy(rng)), r, sf::Color::Black);
+            }
+            break;
+        }
+        case Distribution::Dense: {
+            // Uniform over a centred square holding ~2 particles per 4x4 cell, so most pairs overlap.
+            const float side = std::min<float>(SCREEN_WIDTH - 2.f * margin, std::sqrt(count * 8.f));
+            const float x0 = (SCREEN_WIDTH  - side) / 2.f;
+            const float y0 = (SCREEN_HEIGHT - side) / 2.f;
+            std::uniform_real_distribution<float> u(0.f, side);
+            for (int i = 0; i < count; ++i) {
+                particles.emplace_back(sf::Vector2f(x0 + u(rng), y0 + u(rng)), r, sf::Color::Black);
+            }
+            break;
+        }
+        case Distribution::Piled: {
+            // Touching rows stacked from the bottom edge with a small jitter, like a settled pile.
+            // Above pileCapacity() the spacing shrinks until the whole count fits on screen.
+            const float w = SCREEN_WIDTH  - 2.f * margin;
+            const float h = SCREEN_HEIGHT - 2.f * margin;
+            float spacing = std::min(2.f * r, std::sqrt(w * h / std::max(count, 1)));
+            while (static_cast<long>(w / spacing) * static_cast<long>(h / spacing) < count) spacing *= 0.995f;
+            const int perRow = static_cast<int>(w / spacing);
+            std::uniform_real_distribution<float> jitter(0.f, 0.1f);
+            for (int i = 0; i < count; ++i) {
+                const float x = margin + static_cast<float>(i % perRow) * spacing + jitter(rng);
+                const float y = SCREEN_HEIGHT - margin - static_cast<float>(i / perRow) * spacing;
+                particles.emplace_back(sf::Vector2f(x, y), r, sf::Color::Black);
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,227 @@
+// Kernel-level microbenchmarks for the simulation and rendering hot paths.
+//
+//   ./particle-sim-bench [--particles=10000,50000] [--threads=1,8] [--warmup=3] [--reps=20]
+//                        [--filter=substring] [--json=out.json] [--label=commit]
+//
+// Every case is rebuilt from seeded synthetic layouts, so JSON output from two commits can be diffed.
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Config.hpp"
+#include "Distributions.hpp"
+#include "ImageInput.hpp"
+#include "Particle.hpp"
+#include "ParticleRenderer.hpp"
+#include "SplatRenderer.hpp"
+#include "RunConfig.hpp"
+#include "World.hpp"
+
+struct WorldBench {
+    static void buildGrid(World& w)                            { w.buildGrid(); }
+    static void solveSlice(World& w, const Slice& s)           { w.solveSlice(s); }
+    static void runPass(World& w, const std::vector<Slice>& s) { w.runPass(s); }
+    static void runJobs(World& w, std::size_t n, const SplatRenderer::Job& job) { w.runJobs(n, job); }
+    static void resolveCollision(World& w, Particle& a, Particle& b) { w.resolveCollision(a, b); }
+
+    static void solvePasses(World& w) {
+        w.runPass(w.evenSlices);
+        w.runPass(w.oddSlices);
+    }
+
+    static void jacobiGather(World& w) {
+        w.runJobs(w.jacobiSlices.size(), [&w] (std::size_t j) {
+            w.gatherSlice(w.jacobiSlices[j]);
+        });
+    }
+
+    // Candidate pairs in the order solveSlice visits them: within each cell, then against the
+    // four forward neighbours. Requires a built grid.
+    static std::vector<std::pair<int, int>> neighbourPairs(const World& w) {
+        std::vector<std::pair<int, int>> pairs;
+
+        for (int x = 0; x < World::GRID_COLS; ++x) {
+            for (int y = 0; y < World::GRID_ROWS; ++y) {
+                const World::Cell& c = w.grid[w.cellIndex(x, y)];
+
+                for (int i = 0; i < c.count; ++i) {
+                    for (int j = i + 1; j < c.count; ++j) pairs.emplace_back(c.ids[i], c.ids[j]);
+                }
+
+                for (int k = 0; k < 4; ++k) {
+                    const int nx = x + World::ndx[k];
+                    const int ny = y + World::ndy[k];
+                    if (!w.inBoundsCell(nx, ny)) continue;
+
+                    const World::Cell& n = w.grid[w.cellIndex(nx, ny)];
+                    for (int i = 0; i < c.count; ++i) {
+                        for (int j = 0; j < n.count; ++j) pairs.emplace_back(c.ids[i], n.ids[j]);
+                    }
+                }
+            }
+        }
+        return pairs;
+    }
+
+    static int gridCols() { return World::GRID_COLS; }
+};
+
+namespace {
+
+const Distribution DISTRIBUTIONS[] = { Distribution::Sparse, Distribution::Dense, Distribution::Piled };
+
+void benchSingleThreaded(bench::Runner& runner, const RunConfig& base, int count) {
+    RunConfig cfg = base;
+    cfg.threadCount = 1;
+    World world(count, 1, false, cfg);
+    auto& particles = world.particles;
+    std::vector<Particle> snapshot;
+
+    for (Distribution d : DISTRIBUTIONS) {
+        const std::string dist = distributionName(d);
+        fillParticles(snapshot, count, d);
+        auto restore = [&] () { particles.assign(snapshot.begin(), snapshot.end()); };
+
+        // Real broad-phase candidates, so the overlap fraction follows the layout.
+        restore();
+        WorldBench::buildGrid(world);
+        const auto pairs = WorldBench::neighbourPairs(world);
+        runner.run({ "resolveCollision", dist, count, 1, static_cast<long>(pairs.size()) }, restore, [&] () {
+            for (const auto& [a, b] : pairs) {
+                WorldBench::resolveCollision(world, particles[a], particles[b]);
+            }
+        });
+
+        runner.run({ "buildGrid", dist, count, 1, count }, restore, [&] () {
+            WorldBench::buildGrid(world);
+        });
+
+        runner.run({ "solveSlice", dist, count, 1, count }, [&] () {
+            restore();
+            WorldBench::buildGrid(world);
+        }, [&] () {
+            WorldBench::solveSlice(world, Slice{ 0, WorldBench::gridCols() });
+        });
+    }
+
+    // Integration and rendering do not depend on the layout; use the pile.
+    fillParticles(snapshot, count, Distribution::Piled);
+    auto restore = [&] () { particles.assign(snapshot.begin(), snapshot.end()); };
+    const float substepDt = 1.f / 60.f / 8.f;
+
+    runner.run({ "integrate", "piled", count, 1, count }, restore, [&] () {
+        for (auto& p : particles) p.integrate(substepDt);
+    });
+
+    runner.run({ "applyBorderBounce", "piled", count, 1, count }, restore, [&] () {
+        for (auto& p : particles) {
+            p.applyBorderBounce((float)SCREEN_WIDTH, (float)SCREEN_HEIGHT, 4.f, 0.8f);
+        }
+    });
+
+    if (runner.enabled("ParticleRenderer::build")) {
+        ParticleRenderer renderer(count);
+        restore();
+        runner.run({ "ParticleRenderer::build", "piled", count, 1, count }, [] () {}, [&] () {
+            renderer.build(particles);
+        });
+    }
+
+    if (runner.enabled("ImageInput::sample")) {
+        sf::Image img;
+        img.create((unsigned)SCREEN_WIDTH, (unsigned)SCREEN_HEIGHT, sf::Color(40, 120, 200));
+
+        std::vector<sf::Vector2f> positions;
+        positions.reserve(snapshot.size());
+        for (const auto& p : snapshot) positions.push_back(p.position);
+
+        // Only the colour lookup is timed; parsing output.txt is not part of the kernel.
+        ImageInput input(count);
+        runner.run({ "ImageInput::sample", "piled", count, 1, count }, [] () {}, [&] () {
+            input.sampleTargetColors(img, positions);
+        });
+    }
+}
+
+void benchThreaded(bench::Runner& runner, const RunConfig& base, int count, int threads) {
+    RunConfig cfg = base;
+    cfg.threadCount = threads;
+    World world(count, 1, false, cfg);
+    auto& particles = world.particles;
+    std::vector<Particle> snapshot;
+
+    for (Distribution d : DISTRIBUTIONS) {
+        fillParticles(snapshot, count, d);
+        runner.run({ "solvePasses", distributionName(d), count, threads, count }, [&] () {
+            particles.assign(snapshot.begin(), snapshot.end());
+            WorldBench::buildGrid(world);
+        }, [&] () {
+            WorldBench::solvePasses(world);
+        });
+        runner.run({ "jacobiGather", distributionName(d), count, threads, count }, [&] () {
+            particles.assign(snapshot.begin(), snapshot.end());
+            WorldBench::buildGrid(world);
+        }, [&] () {
+            WorldBench::jacobiGather(world);
+        });
+    }
+
+    if (runner.enabled("SplatRenderer::build")) {
+        sf::RenderTexture target;
+        target.create((unsigned)SCREEN_WIDTH, (unsigned)SCREEN_HEIGHT);
+
+        SplatRenderer splat;
+        const SplatRenderer::ParallelFor pool = [&world] (std::size_t n, const SplatRenderer::Job& job) {
+            WorldBench::runJobs(world, n, job);
+        };
+
+        fillParticles(particles, count, Distribution::Piled);
+        runner.run({ "SplatRenderer::build", "piled", count, threads, count }, [] () {}, [&] () {
+            splat.build(particles, target, pool);
+        });
+    }
+}
+
+void benchDispatch(bench::Runner& runner, const RunConfig& base, int threads) {
+    RunConfig cfg = base;
+    cfg.threadCount = threads;
+    World world(0, 1, false, cfg);
+
+    const int dispatches = 100;
+    const std::vector<Slice> empty(threads, Slice{ 0, 0 });
+    runner.run({ "runPass(empty)", "-", 0, threads, dispatches }, [] () {}, [&] () {
+        for (int i = 0; i < dispatches; ++i) WorldBench::runPass(world, empty);
+    });
+}
+
+}
+
+int main(int argc, char** argv) {
+    const RunConfig base = RunConfig::fromEnvAndArgs(argc, argv);
+    const int hw = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    const std::vector<int> counts  = bench::intListArg(argc, argv, "particles", { 10'000, 50'000 });
+    const std::vector<int> threads = bench::intListArg(argc, argv, "threads", { 1, hw });
+
+    bench::Runner runner(bench::intArg(argc, argv, "warmup", 3),
+                         bench::intArg(argc, argv, "reps", 20),
+                         bench::stringArg(argc, argv, "filter", ""));
+
+    Particle::GRAVITY = { 0.f, 100.f };
+
+    for (int count : counts) {
+        benchSingleThreaded(runner, base, count);
+        for (int t : threads) benchThreaded(runner, base, count, t);
+    }
+    for (int t : threads) benchDispatch(runner, base, t);
+
+    const std::string json = bench::stringArg(argc, argv, "json", "");
+    if (!json.empty() && !runner.writeJson(json, bench::stringArg(argc, argv, "label", ""))) {
+        std::fprintf(stderr, "Failed to write %s\n", json.c_str());
+        return 1;
+    }
+}
@@ -0,0 +1,125 @@
+// Compares the Gauss-Seidel and Jacobi collision solvers on throughput and pile stability.
+//
+//   ./particle-sim-solver-bench [--particles=N] [--threads=1,8] [--settle=N] [--frames=N]
+//
+// Stability is measured after settling: a resting pile should have near-zero residual speed
+// and little overlap between neighbours.
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Config.hpp"
+#include "Distributions.hpp"
+#include "Particle.hpp"
+#include "RunConfig.hpp"
+#include "World.hpp"
+
+namespace {
+
+struct Stability {
+    double meanSpeed = 0;       // px/s, from the last Verlet displacement
+    double meanOverlap = 0;     // px, over overlapping pairs
+    double maxOverlap = 0;
+};
+
+Stability measure(const std::vector<Particle>& particles, float substepDt) {
+    Stability st;
+    if (particles.empty()) return st;
+
+    for (const auto& p : particles) {
+        const sf::Vector2f d = p.getDisplacement();
+        st.meanSpeed += std::sqrt(d.x * d.x + d.y * d.y) / substepDt;
+    }
+    st.meanSpeed /= particles.size();
+
+    // Bucket into 4px cells and check the 3x3 neighbourhood.
+    const int cell = 4;
+    const int cols = SCREEN_WIDTH / cell + 1;
+    const int rows = SCREEN_HEIGHT / cell + 1;
+    std::vector<std::vector<int>> buckets(static_cast<std::size_t>(cols) * rows);
+    auto bucketOf = [&] (const Particle& p, int& cx, int& cy) {
+        cx = std::clamp(static_cast<int>(p.position.x / cell), 0, cols - 1);
+        cy = std::clamp(static_cast<int>(p.position.y / cell), 0, rows - 1);
+    };
+    for (int i = 0; i < static_cast<int>(particles.size()); ++i) {
+        int cx, cy;
+        bucketOf(particles[i], cx, cy);
+        buckets[cx * rows + cy].push_back(i);
+    }
+
+    long pairs = 0;
+    for (int i = 0; i < static_cast<int>(particles.size()); ++i) {
+        const Particle& a = particles[i];
+        int cx, cy;
+        bucketOf(a, cx, cy);
+
+        for (int nx = std::max(0, cx - 1); nx <= std::min(cols - 1, cx + 1); ++nx) {
+            for (int ny = std::max(0, cy - 1); ny <= std::min(rows - 1, cy + 1); ++ny) {
+                for (int j : buckets[nx * rows + ny]) {
+                    if (j <= i) continue;
+                    const sf::Vector2f v = a.position - particles[j].position;
+                    const double overlap = (a.radius + particles[j].radius) - std::sqrt(v.x * v.x + v.y * v.y);
+                    if (overlap <= 0) continue;
+                    st.meanOverlap += overlap;
+                    st.maxOverlap = std::max(st.maxOverlap, overlap);
+                    ++pairs;
+                }
+            }
+        }
+    }
+    if (pairs > 0) st.meanOverlap /= pairs;
+
+    return st;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const RunConfig base = RunConfig::fromEnvAndArgs(argc, argv);
+    const int hw = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    const int particleCount        = bench::intArg(argc, argv, "particles", 40'000);
+    const int settle               = bench::intArg(argc, argv, "settle", 300);
+    const int frames               = bench::intArg(argc, argv, "frames", 200);
+    const std::vector<int> threads = bench::intListArg(argc, argv, "threads", { 1, hw });
+
+    const int substeps = 8;
+    const float substepDt = 1.f / 60.f / substeps;
+
+    Particle::GRAVITY = {0.f, 100.f};
+
+    std::printf("%d particles, %d settle frames, %d timed frames\n", particleCount, settle, frames);
+    if (particleCount > pileCapacity()) {
+        std::printf("note: %d particles exceed the %d that fit a resting pile; the pile starts compressed\n",
+                    particleCount, pileCapacity());
+    }
+    std::printf("%-14s %7s %7s %12s %14s %14s %14s\n",
+                "solver", "layout", "threads", "ms/frame", "speed px/s", "mean overlap", "max overlap");
+
+    for (Distribution d : { Distribution::Piled, Distribution::Dense }) {
+        for (Solver solver : { Solver::GaussSeidel, Solver::Jacobi }) {
+            for (int t : threads) {
+                RunConfig cfg = base;
+                cfg.threadCount = t;
+                cfg.solver = solver;
+
+                World world(particleCount, substeps, false, cfg);
+                fillParticles(world.particles, particleCount, d);
+
+                const double ms = bench::timeFrames(world, settle, frames);
+
+                const Stability st = measure(world.particles, substepDt);
+                std::printf("%-14s %7s %7d %12.3f %14.3f %14.4f %14.4f\n",
+                            solver == Solver::Jacobi ? "jacobi" : "gauss-seidel", distributionName(d), t,
+                            ms, st.meanSpeed, st.meanOverlap, st.maxOverlap);
+                std::fflush(stdout);
+            }
+        }
+    }
+}
@@ -5,9 +5,12 @@
 #include "World.hpp"
 #include "Particle.hpp"
 #include "VisualText.hpp"
+#include "RunConfig.hpp"
 
-int main() {
+int main(int argc, char** argv) {
     srand(1);
+    const RunConfig config = RunConfig::fromEnvAndArgs(argc, argv);
+
     sf::RenderWindow window(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "Particle Sim");
     window.setFramerateLimit(60);
 
@@ -16,8 +19,8 @@ int main() {
     VisualText visualText;
     InputState inpState;
 
-    // Particle count, substeps, savePos (1 = yes, 0 = no)
-    World world(56'000, 8, 0);
+    // Particle count, substeps, savePos (1 = yes, 0 = no), run config
+    World world(56'000, 8, 0, config);
 
     while (window.isOpen()) {
         sf::Event event;